@@ -2,10 +2,12 @@
 
 
 #include "OBRuntimeLogCaptureSubsystem.h"
-#include "Misc/FileHelper.h" // NEW: Cần cho việc ghi file
 #include "HAL/PlatformFileManager.h" // NEW: Cần cho việc quản lý file
 #include "Misc/Paths.h" // NEW: Cần để lấy các đường dẫn chuẩn
 #include "HAL/IConsoleManager.h" // NEW: Cần cho console command
+#include "OBRuntimeLogExporter.h"
+#include "Async/Async.h"
+#include "Misc/Parse.h"
 
 void UOBRuntimeLogCaptureSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -19,8 +21,11 @@ void UOBRuntimeLogCaptureSubsystem::Initialize(FSubsystemCollectionBase& Collect
 
 	SaveLogsCommand = MakeUnique<FAutoConsoleCommand>(
 		TEXT("Log.SaveToFile"),
-		TEXT("Saves the runtime captured logs to a file in the project's Saved/Logs directory."),
-		FConsoleCommandDelegate::CreateUObject(this, &UOBRuntimeLogCaptureSubsystem::SaveLogsToFile_FromConsole)
+		TEXT("Saves the runtime captured logs to a file in the project's Saved/Logs directory, on a background thread.\n")
+		TEXT("Optional arguments: Format=txt|jsonl|csv File=<name> Verbosity=<Fatal..VeryVerbose> Filter=\"<text>\"\n")
+		TEXT("Last=<seconds> | From=<ISO 8601 UTC>, To=<ISO 8601 UTC>. Last and From cannot be combined.\n")
+		TEXT("Quote the Filter text if it contains spaces, e.g. Filter=\"Load map\"."),
+		FConsoleCommandWithArgsDelegate::CreateUObject(this, &UOBRuntimeLogCaptureSubsystem::HandleSaveToFileCommand)
 	);
 
 	UE_LOG(LogTemp, Log, TEXT("RuntimeLogCaptureSubsystem Initialized."));
@@ -30,7 +35,15 @@ void UOBRuntimeLogCaptureSubsystem::Deinitialize()
 {
 	// NEW: Tự động lưu log khi subsystem bị hủy (khi game thoát)
 	UE_LOG(LogTemp, Log, TEXT("RuntimeLogCaptureSubsystem Deinitializing. Attempting to save logs..."));
-	SaveLogsToFile_FromConsole();
+	// Let a running export finish before the final synchronous save.
+	// Its completion is still queued on the game thread, so unbind the listeners that are being torn down.
+	if (PendingExport.IsValid())
+	{
+		PendingExport.Wait();
+	}
+	OnExportProgress.Clear();
+	OnExportCompleted.Clear();
+	SaveLogsToFile(FString());
 
 	if (GLog && LogOutputDevice.IsValid())
 	{
@@ -52,12 +65,18 @@ void UOBRuntimeLogCaptureSubsystem::GetCapturedLogs(TArray<FOBLogMessage>& OutLo
 
 void UOBRuntimeLogCaptureSubsystem::SaveLogsToFile_FromConsole()
 {
-	// Gọi hàm gốc và bỏ qua giá trị trả về của nó.
-	// Console command không cần biết đường dẫn file, vì nó đã được in ra log.
-	SaveLogsToFile(TEXT(""));
+	SaveLogsToFileAsync(FString(), FOBLogExportOptions());
+}
+
+FString UOBRuntimeLogCaptureSubsystem::SaveLogsToFile(const FString& OptionalFilename,
+                                                     const FOBLogExportOptions& Options)
+{
+	return SaveLogsToFile(OptionalFilename, Options, IOBLogExporter::Create(Options.Format));
 }
 
-FString UOBRuntimeLogCaptureSubsystem::SaveLogsToFile(const FString& OptionalFilename)
+FString UOBRuntimeLogCaptureSubsystem::SaveLogsToFile(const FString& OptionalFilename,
+                                                     const FOBLogExportOptions& Options,
+                                                     const TSharedRef<IOBLogExporter>& Exporter)
 {
 	TArray<FOBLogMessage> LogsToSave;
 	GetCapturedLogs(LogsToSave);
@@ -68,51 +87,260 @@ FString UOBRuntimeLogCaptureSubsystem::SaveLogsToFile(const FString& OptionalFil
 		return FString();
 	}
 
-	// Tạo tên file nếu không được cung cấp
-	FString Filename = OptionalFilename;
-	if (Filename.IsEmpty())
+	const FString FullPath = MakeExportPath(OptionalFilename, Exporter->GetFileExtension());
+
+	int32 ExportedCount = 0;
+	if (!Exporter->WriteToFile(LogsToSave, Options, FullPath, [](int32, int32) {}, ExportedCount))
 	{
-		Filename = FString::Printf(TEXT("%s-RuntimeLog-%s.txt"),
-								   FApp::GetProjectName(),
-								   *FDateTime::Now().ToString(TEXT("%Y.%m.%d-%H.%M.%S")));
+		UE_LOG(LogTemp, Error, TEXT("Failed to save logs to: %s"), *FullPath);
+		return FString();
 	}
-	else if (!Filename.EndsWith(TEXT(".txt")))
+
+	if (ExportedCount == 0)
 	{
-		Filename.Append(TEXT(".txt"));
+		UE_LOG(LogTemp, Warning, TEXT("SaveLogsToFile: None of the %d captured logs matched the filter, no file written."),
+		       LogsToSave.Num());
+		return FString();
 	}
 
-	// Lấy đường dẫn thư mục Logs chuẩn của project
-	const FString SaveDirectory = FPaths::ProjectLogDir();
-	const FString FullPath = SaveDirectory + Filename;
+	UE_LOG(LogTemp, Log, TEXT("Successfully saved %d logs to: %s"), ExportedCount, *FullPath);
+	return FullPath;
+}
+
+FString UOBRuntimeLogCaptureSubsystem::SaveLogsToFileAsync(const FString& OptionalFilename,
+                                                          const FOBLogExportOptions& Options)
+{
+	return SaveLogsToFileAsync(OptionalFilename, Options, IOBLogExporter::Create(Options.Format));
+}
+
+FString UOBRuntimeLogCaptureSubsystem::SaveLogsToFileAsync(const FString& OptionalFilename,
+                                                          const FOBLogExportOptions& Options,
+                                                          const TSharedRef<IOBLogExporter>& Exporter)
+{
+	if (IsExportInProgress())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SaveLogsToFileAsync: An export is already in progress."));
+		return FString();
+	}
+
+	// Snapshot the buffer so the capture can keep running while the file is written.
+	TArray<FOBLogMessage> LogsToSave;
+	GetCapturedLogs(LogsToSave);
+
+	if (LogsToSave.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SaveLogsToFileAsync: No logs captured, nothing to save."));
+		return FString();
+	}
+
+	const FString FullPath = MakeExportPath(OptionalFilename, Exporter->GetFileExtension());
+	TWeakObjectPtr<UOBRuntimeLogCaptureSubsystem> WeakThis(this);
+
+	PendingExport = Async(EAsyncExecution::ThreadPool,
+		[WeakThis, LogsToSave = MoveTemp(LogsToSave), Options, FullPath, Exporter]() -> bool
+		{
+			int32 ExportedCount = 0;
+			const bool bSuccess = Exporter->WriteToFile(LogsToSave, Options, FullPath,
+				[WeakThis](int32 ProcessedCount, int32 TotalCount)
+				{
+					AsyncTask(ENamedThreads::GameThread, [WeakThis, ProcessedCount, TotalCount]()
+					{
+						if (WeakThis.IsValid())
+						{
+							WeakThis->OnExportProgress.Broadcast(ProcessedCount, TotalCount);
+						}
+					});
+				}, ExportedCount);
 
-	// Chuẩn bị nội dung để ghi
-	TArray<FString> LinesToSave;
-	LinesToSave.Reserve(LogsToSave.Num());
+			if (!bSuccess)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to save logs to: %s"), *FullPath);
+			}
+			else if (ExportedCount == 0)
+			{
+				UE_LOG(LogTemp, Warning,
+				       TEXT("SaveLogsToFileAsync: None of the %d captured logs matched the filter, no file written."),
+				       LogsToSave.Num());
+			}
+			else
+			{
+				UE_LOG(LogTemp, Log, TEXT("Successfully saved %d logs to: %s"), ExportedCount, *FullPath);
+			}
 
-	for (const FOBLogMessage& Log : LogsToSave)
+			const FString WrittenPath = bSuccess && ExportedCount > 0 ? FullPath : FString();
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, bSuccess, ExportedCount, WrittenPath]()
+			{
+				if (WeakThis.IsValid())
+				{
+					WeakThis->OnExportCompleted.Broadcast(bSuccess, ExportedCount, WrittenPath);
+				}
+			});
+
+			return bSuccess;
+		});
+
+	return FullPath;
+}
+
+bool UOBRuntimeLogCaptureSubsystem::IsExportInProgress() const
+{
+	return PendingExport.IsValid() && !PendingExport.IsReady();
+}
+
+void UOBRuntimeLogCaptureSubsystem::HandleSaveToFileCommand(const TArray<FString>& Args)
+{
+	// The console splits the parameters on whitespace, so glue quoted values back together first.
+	// A quote opens when a value starts with '"' and closes on the first later piece ending with '"'.
+	TArray<FString> Params;
+	bool bInQuotes = false;
+	for (const FString& Arg : Args)
 	{
-		// Định dạng mỗi dòng log
-		// [Timestamp][Category][Verbosity] Message
-		FString FormattedLine = FString::Printf(TEXT("[%s][%s][%s] %s"),
-												*Log.Timestamp.ToString(TEXT("%Y.%m.%d-%H:%M:%S:%l")),
-												*Log.Category.ToString(),
-												*VerbosityToString(Log.Verbosity),
-												*Log.Message
-		);
-		LinesToSave.Add(FormattedLine);
+		if (bInQuotes)
+		{
+			Params.Last() += TEXT(" ") + Arg;
+			bInQuotes = !Arg.EndsWith(TEXT("\""));
+			continue;
+		}
+
+		Params.Add(Arg);
+
+		int32 EqualsIndex = INDEX_NONE;
+		if (Arg.FindChar(TEXT('='), EqualsIndex))
+		{
+			const FString Value = Arg.Mid(EqualsIndex + 1);
+			bInQuotes = Value.StartsWith(TEXT("\"")) && (Value.Len() == 1 || !Value.EndsWith(TEXT("\"")));
+		}
+	}
+	if (bInQuotes)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Log.SaveToFile: Unterminated quote in '%s'."), *Params.Last());
+	}
+
+	FString Filename;
+	FOBLogExportOptions Options;
+	bool bHasLast = false;
+	bool bHasFrom = false;
+
+	for (const FString& Param : Params)
+	{
+		FString Key;
+		FString Value;
+		if (!Param.Split(TEXT("="), &Key, &Value))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Log.SaveToFile: Ignoring argument '%s', expected Key=Value."), *Param);
+			continue;
+		}
+		Value = Value.TrimQuotes();
+
+		if (Key == TEXT("File"))
+		{
+			Filename = Value;
+		}
+		else if (Key == TEXT("Format"))
+		{
+			if (Value == TEXT("jsonl") || Value == TEXT("json"))
+			{
+				Options.Format = EOBLogExportFormat::JsonLines;
+			}
+			else if (Value == TEXT("csv"))
+			{
+				Options.Format = EOBLogExportFormat::Csv;
+			}
+			else if (Value != TEXT("txt") && Value != TEXT("text"))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Log.SaveToFile: Unknown format '%s', using txt."), *Value);
+			}
+		}
+		else if (Key == TEXT("Verbosity"))
+		{
+			const UEnum* VerbosityEnum = StaticEnum<EOBRuntimeLogVerbosity>();
+			const int64 EnumValue = VerbosityEnum->GetValueByNameString(Value);
+			if (EnumValue != INDEX_NONE)
+			{
+				Options.MaxVerbosity = static_cast<EOBRuntimeLogVerbosity>(EnumValue);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Log.SaveToFile: Unknown verbosity '%s', ignored."), *Value);
+			}
+		}
+		else if (Key == TEXT("Filter"))
+		{
+			Options.FilterText = Value;
+		}
+		else if (Key == TEXT("Last"))
+		{
+			const float LastSeconds = FCString::Atof(*Value);
+			if (LastSeconds > 0.f)
+			{
+				Options.StartTime = FDateTime::UtcNow() - FTimespan::FromSeconds(LastSeconds);
+				bHasLast = true;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Log.SaveToFile: Invalid Last duration '%s', ignored."), *Value);
+			}
+		}
+		else if (Key == TEXT("From"))
+		{
+			bHasFrom = FDateTime::ParseIso8601(*Value, Options.StartTime);
+			if (!bHasFrom)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Log.SaveToFile: Invalid From time '%s', ignored."), *Value);
+			}
+		}
+		else if (Key == TEXT("To"))
+		{
+			if (!FDateTime::ParseIso8601(*Value, Options.EndTime))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Log.SaveToFile: Invalid To time '%s', ignored."), *Value);
+			}
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Log.SaveToFile: Unknown argument '%s', ignored."), *Key);
+		}
 	}
 
-	// Ghi mảng chuỗi ra file. FFileHelper sẽ xử lý việc tạo file và ghi nội dung.
-	if (FFileHelper::SaveStringArrayToFile(LinesToSave, *FullPath))
+	// Both set the start of the range, so neither can silently win.
+	if (bHasLast && bHasFrom)
 	{
-		UE_LOG(LogTemp, Log, TEXT("Successfully saved %d logs to: %s"), LogsToSave.Num(), *FullPath);
+		UE_LOG(LogTemp, Error, TEXT("Log.SaveToFile: Last= and From= cannot be combined, nothing saved."));
+		return;
+	}
+
+	SaveLogsToFileAsync(Filename, Options);
+}
+
+FString UOBRuntimeLogCaptureSubsystem::MakeExportPath(const FString& OptionalFilename, const TCHAR* Extension)
+{
+	const FString DotExtension = FString(TEXT(".")) + Extension;
+
+	// Lấy đường dẫn thư mục Logs chuẩn của project
+	const FString SaveDirectory = FPaths::ProjectLogDir();
+
+	// Tạo tên file nếu không được cung cấp
+	if (OptionalFilename.IsEmpty())
+	{
+		// The timestamp only has one-second resolution, so two exports in the same second
+		// (e.g. a console export followed by the save on shutdown) would otherwise share a name.
+		const FString BaseName = FString::Printf(TEXT("%s-RuntimeLog-%s"),
+		                                         FApp::GetProjectName(),
+		                                         *FDateTime::Now().ToString(TEXT("%Y.%m.%d-%H.%M.%S")));
+		FString FullPath = SaveDirectory + BaseName + DotExtension;
+		for (int32 Suffix = 1; FPaths::FileExists(FullPath); ++Suffix)
+		{
+			FullPath = FString::Printf(TEXT("%s%s-%d%s"), *SaveDirectory, *BaseName, Suffix, *DotExtension);
+		}
 		return FullPath;
 	}
-	else
+
+	FString Filename = OptionalFilename;
+	if (!Filename.EndsWith(DotExtension))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to save logs to: %s"), *FullPath);
-		return FString();
+		Filename.Append(DotExtension);
 	}
+	return SaveDirectory + Filename;
 }
 
 void UOBRuntimeLogCaptureSubsystem::CaptureLog(const TCHAR* Message, ELogVerbosity::Type Verbosity,
@@ -152,7 +380,7 @@ EOBRuntimeLogVerbosity UOBRuntimeLogCaptureSubsystem::ConvertEngineVerbosity(ELo
 	}
 }
 
-FString UOBRuntimeLogCaptureSubsystem::VerbosityToString(EOBRuntimeLogVerbosity Verbosity)
+const TCHAR* UOBRuntimeLogCaptureSubsystem::VerbosityToString(EOBRuntimeLogVerbosity Verbosity)
 {
 	switch (Verbosity)
 	{
@@ -0,0 +1,243 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OBRuntimeLogExporter.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// FDateTime::ToString / ToIso8601 return a new string; these write straight into the scratch buffer instead.
+	void AppendTimestamp(const FDateTime& Timestamp, FString& Out)
+	{
+		// %Y.%m.%d-%H:%M:%S:%l
+		Out.Appendf(TEXT("%04d.%02d.%02d-%02d:%02d:%02d:%03d"), Timestamp.GetYear(), Timestamp.GetMonth(),
+		            Timestamp.GetDay(), Timestamp.GetHour(), Timestamp.GetMinute(), Timestamp.GetSecond(),
+		            Timestamp.GetMillisecond());
+	}
+
+	void AppendIso8601(const FDateTime& Timestamp, FString& Out)
+	{
+		Out.Appendf(TEXT("%04d-%02d-%02dT%02d:%02d:%02d.%03dZ"), Timestamp.GetYear(), Timestamp.GetMonth(),
+		            Timestamp.GetDay(), Timestamp.GetHour(), Timestamp.GetMinute(), Timestamp.GetSecond(),
+		            Timestamp.GetMillisecond());
+	}
+
+	// [Timestamp][Category][Verbosity] Message
+	class FOBTextLogExporter final : public IOBLogExporter
+	{
+	public:
+		virtual const TCHAR* GetFileExtension() const override { return TEXT("txt"); }
+
+		virtual void AppendEntry(const FOBLogMessage& Log, FString& Out) const override
+		{
+			Out += TEXT('[');
+			AppendTimestamp(Log.Timestamp, Out);
+			Out += TEXT("][");
+			Log.Category.AppendString(Out);
+			Out += TEXT("][");
+			Out += UOBRuntimeLogCaptureSubsystem::VerbosityToString(Log.Verbosity);
+			Out += TEXT("] ");
+			Out += Log.Message;
+			Out += LINE_TERMINATOR;
+		}
+	};
+
+	// {"timestamp":"...","category":"...","verbosity":"...","message":"..."}
+	class FOBJsonLinesLogExporter final : public IOBLogExporter
+	{
+	public:
+		virtual const TCHAR* GetFileExtension() const override { return TEXT("jsonl"); }
+
+		virtual void AppendEntry(const FOBLogMessage& Log, FString& Out) const override
+		{
+			Out += TEXT("{\"timestamp\":\"");
+			AppendIso8601(Log.Timestamp, Out);
+			Out += TEXT("\",\"category\":\"");
+			AppendEscaped(FNameBuilder(Log.Category).ToView(), Out);
+			Out += TEXT("\",\"verbosity\":\"");
+			Out += UOBRuntimeLogCaptureSubsystem::VerbosityToString(Log.Verbosity);
+			Out += TEXT("\",\"message\":\"");
+			AppendEscaped(Log.Message, Out);
+			// JSON Lines requires '\n' regardless of the platform.
+			Out += TEXT("\"}\n");
+		}
+
+	private:
+		static void AppendEscaped(FStringView Value, FString& Out)
+		{
+			for (const TCHAR Char : Value)
+			{
+				switch (Char)
+				{
+				case TEXT('"'): Out += TEXT("\\\""); break;
+				case TEXT('\\'): Out += TEXT("\\\\"); break;
+				case TEXT('\n'): Out += TEXT("\\n"); break;
+				case TEXT('\r'): Out += TEXT("\\r"); break;
+				case TEXT('\t'): Out += TEXT("\\t"); break;
+				default:
+					if (Char < 0x20)
+					{
+						Out.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+					}
+					else
+					{
+						Out.AppendChar(Char);
+					}
+				}
+			}
+		}
+	};
+
+	// RFC 4180 CSV: Timestamp,Category,Verbosity,Message
+	class FOBCsvLogExporter final : public IOBLogExporter
+	{
+	public:
+		virtual const TCHAR* GetFileExtension() const override { return TEXT("csv"); }
+
+		virtual void AppendHeader(FString& Out) const override
+		{
+			Out += TEXT("Timestamp,Category,Verbosity,Message\r\n");
+		}
+
+		virtual void AppendEntry(const FOBLogMessage& Log, FString& Out) const override
+		{
+			AppendIso8601(Log.Timestamp, Out);
+			Out += TEXT(',');
+			AppendField(FNameBuilder(Log.Category).ToView(), Out);
+			Out += TEXT(',');
+			Out += UOBRuntimeLogCaptureSubsystem::VerbosityToString(Log.Verbosity);
+			Out += TEXT(',');
+			AppendField(Log.Message, Out);
+			Out += TEXT("\r\n");
+		}
+
+	private:
+		// Fields are always quoted so messages containing commas or line breaks stay in one cell.
+		static void AppendField(FStringView Value, FString& Out)
+		{
+			Out += TEXT('"');
+			for (const TCHAR Char : Value)
+			{
+				if (Char == TEXT('"'))
+				{
+					Out += TEXT('"');
+				}
+				Out.AppendChar(Char);
+			}
+			Out += TEXT('"');
+		}
+	};
+}
+
+TSharedRef<IOBLogExporter> IOBLogExporter::Create(EOBLogExportFormat Format)
+{
+	switch (Format)
+	{
+	case EOBLogExportFormat::JsonLines: return MakeShared<FOBJsonLinesLogExporter>();
+	case EOBLogExportFormat::Csv: return MakeShared<FOBCsvLogExporter>();
+	case EOBLogExportFormat::Text:
+	default: return MakeShared<FOBTextLogExporter>();
+	}
+}
+
+bool IOBLogExporter::WriteToFile(const TArray<FOBLogMessage>& Logs, const FOBLogExportOptions& Options,
+                                 const FString& FullPath, TFunctionRef<void(int32, int32)> OnProgress,
+                                 int32& OutExportedCount) const
+{
+	OutExportedCount = 0;
+
+	// Write next to the destination and move it into place only once complete, so a failed export
+	// neither leaves a truncated file behind nor destroys a previous export with the same name.
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString TempPath = FullPath + TEXT(".tmp");
+
+	// Opened on the first matching entry, so an export that matches nothing never creates a file.
+	TUniquePtr<IFileHandle> FileHandle;
+
+	auto Fail = [&]() -> bool
+	{
+		FileHandle.Reset();
+		PlatformFile.DeleteFile(*TempPath);
+		return false;
+	};
+
+	// Formatted text of the current chunk. Reset() keeps the allocation, so it is only grown once.
+	FString Scratch;
+	Scratch.Reserve(ChunkSize + 1024);
+	// UTF-8 encoding of the scratch buffer, reused the same way.
+	TArray<UTF8CHAR> Encoded;
+
+	auto Flush = [&]() -> bool
+	{
+		if (Scratch.IsEmpty())
+		{
+			return true;
+		}
+
+		const int32 EncodedLength = FPlatformString::ConvertedLength<UTF8CHAR>(*Scratch, Scratch.Len());
+		Encoded.Reset(EncodedLength);
+		Encoded.AddUninitialized(EncodedLength);
+		FPlatformString::Convert(Encoded.GetData(), EncodedLength, *Scratch, Scratch.Len());
+		Scratch.Reset();
+
+		return FileHandle->Write(reinterpret_cast<const uint8*>(Encoded.GetData()), EncodedLength);
+	};
+
+	const int32 TotalCount = Logs.Num();
+	for (int32 Index = 0; Index < TotalCount; ++Index)
+	{
+		const FOBLogMessage& Log = Logs[Index];
+		if (!Options.Matches(Log))
+		{
+			continue;
+		}
+
+		if (!FileHandle.IsValid())
+		{
+			PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FullPath));
+			FileHandle.Reset(PlatformFile.OpenWrite(*TempPath));
+			if (!FileHandle.IsValid())
+			{
+				return false;
+			}
+			AppendHeader(Scratch);
+		}
+
+		AppendEntry(Log, Scratch);
+		++OutExportedCount;
+
+		if (Scratch.Len() >= ChunkSize)
+		{
+			if (!Flush())
+			{
+				return Fail();
+			}
+			OnProgress(Index + 1, TotalCount);
+		}
+	}
+
+	if (!FileHandle.IsValid())
+	{
+		return true;
+	}
+
+	if (!Flush() || !FileHandle->Flush())
+	{
+		return Fail();
+	}
+	// Close the handle before moving the file.
+	FileHandle.Reset();
+
+	if (PlatformFile.FileExists(*FullPath) && !PlatformFile.DeleteFile(*FullPath))
+	{
+		return Fail();
+	}
+	if (!PlatformFile.MoveFile(*FullPath, *TempPath))
+	{
+		return Fail();
+	}
+
+	OnProgress(TotalCount, TotalCount);
+	return true;
+}
@@ -6,6 +6,7 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "OBRuntimeLogOutputDevice.h"
 #include "Logging/LogVerbosity.h"
+#include "Async/Future.h"
 #include "OBRuntimeLogCaptureSubsystem.generated.h"
 
 /**
@@ -48,6 +49,57 @@ struct FOBLogMessage
 	}
 };
 
+/** File layouts supported by the log exporters. */
+UENUM(BlueprintType)
+enum class EOBLogExportFormat : uint8
+{
+	// [Timestamp][Category][Verbosity] Message
+	Text,
+	// One JSON object per line.
+	JsonLines,
+	// Comma-separated values with a header row.
+	Csv
+};
+
+// Options controlling which logs are exported and in which format.
+USTRUCT(BlueprintType)
+struct FOBLogExportOptions
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "Log|Export")
+	EOBLogExportFormat Format = EOBLogExportFormat::Text;
+
+	// Only logs at this level or more severe are exported.
+	UPROPERTY(BlueprintReadWrite, Category = "Log|Export")
+	EOBRuntimeLogVerbosity MaxVerbosity = EOBRuntimeLogVerbosity::VeryVerbose;
+
+	// If not empty, only logs whose message contains this text are exported.
+	UPROPERTY(BlueprintReadWrite, Category = "Log|Export")
+	FString FilterText;
+
+	// Inclusive UTC time range of the exported logs.
+	UPROPERTY(BlueprintReadWrite, Category = "Log|Export")
+	FDateTime StartTime = FDateTime::MinValue();
+
+	UPROPERTY(BlueprintReadWrite, Category = "Log|Export")
+	FDateTime EndTime = FDateTime::MaxValue();
+
+	bool Matches(const FOBLogMessage& Log) const
+	{
+		return Log.Verbosity <= MaxVerbosity
+			&& Log.Timestamp >= StartTime && Log.Timestamp <= EndTime
+			&& (FilterText.IsEmpty() || Log.Message.Contains(FilterText));
+	}
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnOBLogExportProgress, int32, ProcessedCount, int32, TotalCount);
+// FilePath is empty when the export failed or when no entry matched the filter (no file is written then).
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnOBLogExportCompleted, bool, bSuccess, int32, ExportedCount,
+                                               const FString&, FilePath);
+
+class IOBLogExporter;
+
 /**
  * 
  */
@@ -70,9 +122,49 @@ public:
 	 */
 	void GetCapturedLogs(TArray<FOBLogMessage>& OutLogs) const;
 	
-	UFUNCTION(BlueprintCallable, Category = "Runtime Log Viewer")
+	// Kept so existing Blueprints still load; forwards to SaveLogsToFileAsync with the default options.
+	UFUNCTION(BlueprintCallable, Category = "Runtime Log Viewer",
+		meta = (DeprecatedFunction, DeprecationMessage = "Use SaveLogsToFileAsync, which does not block the game thread."))
 	void SaveLogsToFile_FromConsole();
-	FString SaveLogsToFile(const FString& OptionalFilename);
+
+	/**
+	 * Write the captured logs to the project's Saved/Logs directory, blocking until done.
+	 * No file is written if no entry matches the options' filter.
+	 * @return Full path of the written file, or an empty string on failure or when nothing matched.
+	 */
+	FString SaveLogsToFile(const FString& OptionalFilename,
+	                       const FOBLogExportOptions& Options = FOBLogExportOptions());
+
+	// Same as above, using a custom exporter instead of the one matching Options.Format.
+	FString SaveLogsToFile(const FString& OptionalFilename, const FOBLogExportOptions& Options,
+	                       const TSharedRef<IOBLogExporter>& Exporter);
+
+	/**
+	 * Write a snapshot of the captured logs on a background thread.
+	 * Progress and completion are reported on the game thread through OnExportProgress / OnExportCompleted.
+	 * The filter is only evaluated on the worker, so the returned path may never be created (nothing matched,
+	 * or the write failed); the FilePath passed to OnExportCompleted is the actual result.
+	 * @return Full path the export will write to, or an empty string if the export could not be started.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Log Viewer")
+	FString SaveLogsToFileAsync(const FString& OptionalFilename, const FOBLogExportOptions& Options);
+
+	// Same as above, using a custom exporter instead of the one matching Options.Format.
+	// The exporter is used from a worker thread, so it must not depend on game-thread state.
+	FString SaveLogsToFileAsync(const FString& OptionalFilename, const FOBLogExportOptions& Options,
+	                            const TSharedRef<IOBLogExporter>& Exporter);
+
+	/** Whether a background export is still running. */
+	UFUNCTION(BlueprintPure, Category = "Runtime Log Viewer")
+	bool IsExportInProgress() const;
+
+	UPROPERTY(BlueprintAssignable, Category = "Runtime Log Viewer")
+	FOnOBLogExportProgress OnExportProgress;
+
+	UPROPERTY(BlueprintAssignable, Category = "Runtime Log Viewer")
+	FOnOBLogExportCompleted OnExportCompleted;
+
+	static const TCHAR* VerbosityToString(EOBRuntimeLogVerbosity Verbosity);
 
 private:
 	/**
@@ -86,11 +178,19 @@ private:
 
 	static EOBRuntimeLogVerbosity ConvertEngineVerbosity(ELogVerbosity::Type EngineVerbosity);
 
-	static FString VerbosityToString(EOBRuntimeLogVerbosity Verbosity); // NEW: Helper to convert enum to string
+	// Handler of the Log.SaveToFile console command, parses the optional Key=Value arguments.
+	void HandleSaveToFileCommand(const TArray<FString>& Args);
+
+	// Build the full output path, appending the extension if needed.
+	// Generated names get a numeric suffix when a file with the same name already exists.
+	static FString MakeExportPath(const FString& OptionalFilename, const TCHAR* Extension);
 
 	// NEW: Console command object to trigger saving manually
 	TUniquePtr<FAutoConsoleCommand> SaveLogsCommand;
 
+	// Result of the running background export, if any.
+	TFuture<bool> PendingExport;
+
 	// Custom output device to listen to logs from the engine.
 	TUniquePtr<FOBRuntimeLogOutputDevice> LogOutputDevice;
 
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBRuntimeLogCaptureSubsystem.h"
+
+/**
+ * Base class of the log file writers.
+ * The module provides text, JSON Lines and CSV exporters through Create; other modules can derive from this class
+ * and pass their exporter to UOBRuntimeLogCaptureSubsystem::SaveLogsToFile / SaveLogsToFileAsync.
+ * Implementations only format entries; WriteToFile handles filtering and streaming to disk.
+ * Implementations must be stateless, as they are used from a worker thread.
+ */
+class OBRUNTIMELOGVIEWER_API IOBLogExporter
+{
+public:
+	virtual ~IOBLogExporter() = default;
+
+	// Create the exporter matching the given format.
+	static TSharedRef<IOBLogExporter> Create(EOBLogExportFormat Format);
+
+	// File extension without the leading dot.
+	virtual const TCHAR* GetFileExtension() const = 0;
+
+	// Append the lines written once at the beginning of the file (e.g. the CSV header).
+	virtual void AppendHeader(FString& Out) const
+	{
+	}
+
+	// Append one formatted entry, including its line terminator.
+	virtual void AppendEntry(const FOBLogMessage& Log, FString& Out) const = 0;
+
+	/**
+	 * Stream the logs that pass the options' filter into a UTF-8 file.
+	 * Entries are formatted into a single reusable scratch buffer that is flushed every ChunkSize characters,
+	 * so the whole output is never held in memory. If no entry passes the filter, no file is created.
+	 * The data is written to FullPath + ".tmp" and moved into place on success; on failure the temporary file is
+	 * deleted and any existing file at FullPath is left untouched.
+	 * @param Logs - Snapshot of the logs to write.
+	 * @param Options - Filter applied to each entry.
+	 * @param FullPath - Destination file, replaced if it exists.
+	 * @param OnProgress - Called after each flushed chunk with (processed entries, total entries).
+	 * @param OutExportedCount - Number of entries that passed the filter.
+	 * @return True if the whole file was written, or if there was nothing to write.
+	 */
+	bool WriteToFile(const TArray<FOBLogMessage>& Logs, const FOBLogExportOptions& Options, const FString& FullPath,
+	                 TFunctionRef<void(int32, int32)> OnProgress, int32& OutExportedCount) const;
+
+	// Number of characters buffered before each write to disk.
+	static constexpr int32 ChunkSize = 64 * 1024;
+};